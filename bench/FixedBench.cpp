@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+/// Fixed-point versus float benchmark
+///
+/// Build and run from the repository root:
+///   g++ -std=c++17 -O2 -DNDEBUG -Isrc bench/FixedBench.cpp -o fixed_bench
+///   ./fixed_bench
+///
+/// Integrates 100k falling, bouncing bodies for 200 steps in
+/// Fixed16 and in float, then times 10M square roots of each.
+////////////////////////////////////////////////////////////
+
+#include "math/Fixed.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+struct FloatVector2
+{
+    float x;
+    float y;
+};
+
+template <typename Scalar, typename Vector>
+double integrate(std::vector<Vector>& positions, std::vector<Vector>& velocities, Scalar dt, Scalar gravity, Scalar floor, Scalar bounce)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < 200; ++step)
+    {
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            velocities[i].y += gravity * dt;
+            positions[i].x += velocities[i].x * dt;
+            positions[i].y += velocities[i].y * dt;
+
+            if (positions[i].y > floor)
+            {
+                positions[i].y  = floor;
+                velocities[i].y = -velocities[i].y * bounce;
+            }
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Function>
+double time(Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t bodies = 100000;
+
+    std::vector<FixedVector2f> fixedPositions(bodies);
+    std::vector<FixedVector2f> fixedVelocities(bodies, FixedVector2f(Fixed16(1), Fixed16(0)));
+    std::vector<FloatVector2>  floatPositions(bodies, FloatVector2{0.f, 0.f});
+    std::vector<FloatVector2>  floatVelocities(bodies, FloatVector2{1.f, 0.f});
+
+    const double fixedTime = integrate(fixedPositions,
+                                       fixedVelocities,
+                                       Fixed16::fromFloat(1.f / 60.f),
+                                       Fixed16(10),
+                                       Fixed16(100),
+                                       Fixed16(1) / Fixed16(2));
+    const double floatTime = integrate(floatPositions, floatVelocities, 1.f / 60.f, 10.f, 100.f, 0.5f);
+
+    std::printf("integrate %zu bodies x 200 steps: fixed %.2f ms, float %.2f ms\n", bodies, fixedTime, floatTime);
+
+    volatile std::int32_t fixedSink = 0;
+    volatile float        floatSink = 0.f;
+
+    const double fixedSqrt = time([&] {
+        for (std::int32_t i = 1; i < 10000000; ++i)
+            fixedSink = fixedSink + sqrt(Fixed16::fromRaw(i)).raw();
+    });
+    const double floatSqrt = time([&] {
+        for (std::int32_t i = 1; i < 10000000; ++i)
+            floatSink = floatSink + std::sqrt(static_cast<float>(i));
+    });
+
+    std::printf("10M sqrt: fixed %.2f ms, float %.2f ms\n", fixedSqrt, floatSqrt);
+    std::printf("(checksum %.3f %.3f)\n", fixedPositions[0].y.toFloat(), floatPositions[0].y);
+}
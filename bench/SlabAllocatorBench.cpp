@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+/// Slab allocator versus malloc for chunk-wide passes
+///
+/// Build and run from the repository root:
+///   g++ -std=c++17 -O2 -Isrc bench/SlabAllocatorBench.cpp src/memory/SlabAllocator.cpp -o slab_bench
+///   ./slab_bench
+///
+/// Allocates 40k chunk blocks of 32x32 16-bit tiles plus 8-bit
+/// light. They come once from malloc, interleaved with small
+/// allocations the way a live heap fills up, and once from
+/// SlabAllocator. Both sets are visited in the same shuffled
+/// order, like a walk over a hash map of resident chunks, by:
+///  - a light-style pass: seed light from tiles, then decay it
+///    along rows and columns
+///  - a mesh-style pass: emit a quad for every solid tile with
+///    an air neighbour into a shared vertex buffer
+////////////////////////////////////////////////////////////
+
+#include "memory/SlabAllocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int ChunkSize = 32;
+constexpr int ChunkArea = ChunkSize * ChunkSize;
+
+struct ChunkData
+{
+    std::uint16_t tiles[ChunkArea];
+    std::uint8_t  light[ChunkArea];
+};
+
+struct Quad
+{
+    std::int32_t  x;
+    std::int32_t  y;
+    std::uint16_t tile;
+    std::uint8_t  light;
+};
+
+void fill(ChunkData& chunk, std::mt19937& rng)
+{
+    // Mostly stone with pockets of air, like an underground chunk
+    for (auto& tile : chunk.tiles)
+        tile = static_cast<std::uint16_t>(rng() % 4 == 0 ? 0 : 1 + rng() % 6);
+}
+
+void lightPass(ChunkData& chunk)
+{
+    for (int i = 0; i < ChunkArea; ++i)
+        chunk.light[i] = chunk.tiles[i] == 0 ? 15 : 0;
+
+    for (int y = 0; y < ChunkSize; ++y)
+    {
+        std::uint8_t* row = chunk.light + y * ChunkSize;
+        for (int x = 1; x < ChunkSize; ++x)
+            row[x] = std::max<std::uint8_t>(row[x], row[x - 1] > 0 ? row[x - 1] - 1 : 0);
+        for (int x = ChunkSize - 2; x >= 0; --x)
+            row[x] = std::max<std::uint8_t>(row[x], row[x + 1] > 0 ? row[x + 1] - 1 : 0);
+    }
+
+    for (int y = 1; y < ChunkSize; ++y)
+    {
+        for (int x = 0; x < ChunkSize; ++x)
+        {
+            const std::uint8_t above = chunk.light[(y - 1) * ChunkSize + x];
+            std::uint8_t&      here  = chunk.light[y * ChunkSize + x];
+            here                     = std::max<std::uint8_t>(here, above > 0 ? above - 1 : 0);
+        }
+    }
+}
+
+void meshPass(const ChunkData& chunk, int chunkIndex, std::vector<Quad>& quads)
+{
+    for (int y = 0; y < ChunkSize; ++y)
+    {
+        for (int x = 0; x < ChunkSize; ++x)
+        {
+            const int           i    = y * ChunkSize + x;
+            const std::uint16_t tile = chunk.tiles[i];
+            if (tile == 0)
+                continue;
+
+            const bool exposed = (x > 0 && chunk.tiles[i - 1] == 0) || (x + 1 < ChunkSize && chunk.tiles[i + 1] == 0) ||
+                                 (y > 0 && chunk.tiles[i - ChunkSize] == 0) ||
+                                 (y + 1 < ChunkSize && chunk.tiles[i + ChunkSize] == 0);
+            if (exposed)
+                quads.push_back({chunkIndex * ChunkSize + x, y, tile, chunk.light[i]});
+        }
+    }
+}
+
+template <typename Function>
+double millisecondsPerRun(Function function)
+{
+    constexpr int runs  = 10;
+    const auto    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+        function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+struct Result
+{
+    double      light;
+    double      mesh;
+    std::size_t quads;
+};
+
+Result runPasses(const std::vector<ChunkData*>& chunks)
+{
+    std::vector<Quad> quads;
+    quads.reserve(chunks.size() * ChunkArea / 2);
+
+    Result result{};
+    result.light = millisecondsPerRun([&] {
+        for (ChunkData* chunk : chunks)
+            lightPass(*chunk);
+    });
+    result.mesh = millisecondsPerRun([&] {
+        quads.clear();
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+            meshPass(*chunks[i], static_cast<int>(i), quads);
+    });
+    result.quads = quads.size();
+    return result;
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t chunkCount = 40000;
+
+    std::mt19937 rng(3);
+
+    std::vector<ChunkData*> heapChunks;
+    std::vector<void*>      heapNoise;
+    for (std::size_t i = 0; i < chunkCount; ++i)
+    {
+        heapChunks.push_back(new (std::malloc(sizeof(ChunkData))) ChunkData);
+        heapNoise.push_back(std::malloc(rng() % 512 + 16));
+        fill(*heapChunks.back(), rng);
+    }
+
+    SlabAllocator           slab(sizeof(ChunkData));
+    std::vector<ChunkData*> slabChunks;
+    for (std::size_t i = 0; i < chunkCount; ++i)
+    {
+        slabChunks.push_back(new (slab.allocate()) ChunkData);
+        *slabChunks.back() = *heapChunks[i];
+    }
+
+    // Same visiting order for both, so the passes do identical work
+    std::vector<std::size_t> order(chunkCount);
+    for (std::size_t i = 0; i < chunkCount; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::vector<ChunkData*> heapOrder;
+    std::vector<ChunkData*> slabOrder;
+    for (const std::size_t i : order)
+    {
+        heapOrder.push_back(heapChunks[i]);
+        slabOrder.push_back(slabChunks[i]);
+    }
+
+    // Warm up both sets once so neither pays first-touch faults
+    runPasses(heapOrder);
+    runPasses(slabOrder);
+
+    const Result heap  = runPasses(heapOrder);
+    const Result slabs = runPasses(slabOrder);
+
+    const auto& stats = slab.getStats();
+    std::printf("%zu chunks of %zu bytes, %zu slabs (%zu MAP_HUGETLB)\n",
+                chunkCount,
+                sizeof(ChunkData),
+                stats.slabCount,
+                stats.hugeTlbSlabs);
+    std::printf("light pass: malloc %.2f ms, slab %.2f ms\n", heap.light, slabs.light);
+    std::printf("mesh pass:  malloc %.2f ms, slab %.2f ms (%zu quads)\n", heap.mesh, slabs.mesh, slabs.quads);
+
+    for (ChunkData* chunk : slabChunks)
+        slab.deallocate(chunk);
+    for (ChunkData* chunk : heapChunks)
+        std::free(chunk);
+    for (void* noise : heapNoise)
+        std::free(noise);
+
+    return heap.quads == slabs.quads ? 0 : 1;
+}
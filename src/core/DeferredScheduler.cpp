@@ -0,0 +1,89 @@
+#include "DeferredScheduler.hpp"
+
+#include <algorithm>
+
+DeferredScheduler::TaskId DeferredScheduler::add(std::string name, Task task, std::uint32_t starvationLimit)
+{
+    const TaskId id = m_nextId++;
+    m_tasks.push_back({id, std::move(name), std::move(task), std::max<std::uint32_t>(starvationLimit, 1), 0});
+    return id;
+}
+
+void DeferredScheduler::cancel(TaskId id)
+{
+    const auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [id](const Entry& entry) { return entry.id == id; });
+    if (it == m_tasks.end())
+        return;
+
+    const auto index = static_cast<std::size_t>(it - m_tasks.begin());
+    m_tasks.erase(it);
+    if (m_cursor > index)
+        --m_cursor;
+}
+
+void DeferredScheduler::beginFrame()
+{
+    m_frameStart = Clock::now();
+}
+
+void DeferredScheduler::runSlack(Duration budget)
+{
+    const auto slackStart = Clock::now();
+    const auto deadline   = m_frameStart + budget;
+
+    m_stats              = Stats();
+    m_stats.criticalTime = slackStart - m_frameStart;
+
+    for (auto& entry : m_tasks)
+        ++entry.framesSkipped;
+
+    // Starving tasks first, whatever the budget says
+    for (std::size_t i = 0; i < m_tasks.size();)
+    {
+        if (m_tasks[i].framesSkipped > m_tasks[i].starvationLimit)
+        {
+            ++m_stats.starvedSlices;
+            if (!runSlice(i))
+                continue;
+        }
+        ++i;
+    }
+
+    // Then round robin through whatever slack is left
+    while (!m_tasks.empty() && Clock::now() < deadline)
+    {
+        if (m_cursor >= m_tasks.size())
+            m_cursor = 0;
+
+        if (runSlice(m_cursor))
+            ++m_cursor;
+    }
+
+    m_stats.deferredTime = Clock::now() - slackStart;
+}
+
+const DeferredScheduler::Stats& DeferredScheduler::getStats() const
+{
+    return m_stats;
+}
+
+std::size_t DeferredScheduler::getTaskCount() const
+{
+    return m_tasks.size();
+}
+
+bool DeferredScheduler::runSlice(std::size_t index)
+{
+    ++m_stats.slicesRun;
+    m_tasks[index].framesSkipped = 0;
+
+    if (m_tasks[index].task())
+        return true;
+
+    // Finished: remove it, keeping the round-robin cursor on the next task
+    m_tasks.erase(m_tasks.begin() + static_cast<std::ptrdiff_t>(index));
+    if (m_cursor > index)
+        --m_cursor;
+
+    return false;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Runs low-priority work in the slack left in a frame or tick
+///
+/// Call beginFrame() before the critical work and runSlack()
+/// after it. The scheduler measures how long the critical work
+/// took and spends whatever remains of the budget on deferred
+/// tasks, one slice at a time, round robin. A task that has not
+/// run for its starvation limit gets one slice even when the
+/// frame is already over budget, so background work always
+/// finishes eventually.
+////////////////////////////////////////////////////////////
+class DeferredScheduler
+{
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+    using TaskId   = std::uint32_t;
+
+    ////////////////////////////////////////////////////////////
+    /// One slice of work; return true while more work remains
+    ///
+    /// A slice should be short (well under a millisecond) because
+    /// the scheduler can only stop between slices. Slices must not
+    /// add or cancel tasks.
+    ////////////////////////////////////////////////////////////
+    using Task = std::function<bool()>;
+
+    struct Stats
+    {
+        Duration      criticalTime{};  ///< Time between beginFrame() and runSlack()
+        Duration      deferredTime{};  ///< Time spent running slices
+        std::uint32_t slicesRun     = 0;
+        std::uint32_t starvedSlices = 0; ///< Slices forced past the budget
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Queue a task
+    ///
+    /// \param name            Label for profiling and logging
+    /// \param task            Slice function
+    /// \param starvationLimit Frames the task may be skipped before
+    ///                        it is guaranteed a slice
+    ////////////////////////////////////////////////////////////
+    TaskId add(std::string name, Task task, std::uint32_t starvationLimit = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// Drop a task before it finishes; unknown ids are ignored
+    ////////////////////////////////////////////////////////////
+    void cancel(TaskId id);
+
+    ////////////////////////////////////////////////////////////
+    /// Mark the start of the frame's critical work
+    ////////////////////////////////////////////////////////////
+    void beginFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// Run deferred slices until \a budget since beginFrame() is used
+    ////////////////////////////////////////////////////////////
+    void runSlack(Duration budget);
+
+    ////////////////////////////////////////////////////////////
+    /// Statistics of the last runSlack() call
+    ////////////////////////////////////////////////////////////
+    const Stats& getStats() const;
+
+    std::size_t getTaskCount() const;
+
+private:
+    struct Entry
+    {
+        TaskId        id;
+        std::string   name;
+        Task          task;
+        std::uint32_t starvationLimit;
+        std::uint32_t framesSkipped;
+    };
+
+    bool runSlice(std::size_t index);
+
+    std::vector<Entry> m_tasks;
+    std::size_t        m_cursor = 0; ///< Round-robin position
+    TaskId             m_nextId = 0;
+    Clock::time_point  m_frameStart;
+    Stats              m_stats;
+};
@@ -0,0 +1,175 @@
+#include "PerformanceGovernor.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+float toMicroseconds(PerformanceGovernor::Duration duration)
+{
+    return std::chrono::duration<float, std::micro>(duration).count();
+}
+} // namespace
+
+PerformanceGovernor::PerformanceGovernor() : PerformanceGovernor(Settings())
+{
+}
+
+PerformanceGovernor::PerformanceGovernor(const Settings& settings) : m_settings(settings)
+{
+    assert(m_settings.restoreRatio < m_settings.degradeRatio && "restore threshold must sit below degrade threshold");
+}
+
+PerformanceGovernor::KnobId PerformanceGovernor::addKnob(std::string name, std::vector<int> values)
+{
+    assert(!values.empty());
+    m_knobs.push_back({std::move(name), std::move(values), 0, 0, false, 0});
+    return m_knobs.size() - 1;
+}
+
+int PerformanceGovernor::getValue(KnobId knob) const
+{
+    const Knob& entry = m_knobs[knob];
+    return entry.values[entry.level];
+}
+
+std::size_t PerformanceGovernor::getLevel(KnobId knob) const
+{
+    return m_knobs[knob].level;
+}
+
+bool PerformanceGovernor::addSample(Duration frameTime)
+{
+    const float sample = toMicroseconds(frameTime);
+    m_smoothed         = m_hasSample ? m_smoothed + (sample - m_smoothed) * m_settings.smoothing : sample;
+    m_hasSample        = true;
+    ++m_samples;
+
+    // A raise that held long enough was right; forget earlier flicker
+    for (auto& knob : m_knobs)
+    {
+        if (knob.restored && m_samples - knob.restoredAt >= m_settings.stableSamples)
+        {
+            knob.restored = false;
+            knob.backoff  = 0;
+        }
+    }
+
+    const float budget = toMicroseconds(m_settings.budget);
+
+    if (m_smoothed > budget * m_settings.degradeRatio)
+    {
+        ++m_overloaded;
+        m_idle = 0;
+    }
+    else if (m_smoothed < budget * m_settings.restoreRatio)
+    {
+        ++m_idle;
+        m_overloaded = 0;
+    }
+    else
+    {
+        m_overloaded = 0;
+        m_idle       = 0;
+    }
+
+    // Let the last change show up in the measurements before judging again
+    if (m_cooldown > 0)
+    {
+        --m_cooldown;
+        return false;
+    }
+
+    bool changed = false;
+    if (m_overloaded >= m_settings.degradeSamples)
+        changed = degrade();
+    else if (!m_lowered.empty() &&
+             m_idle >= (std::uint64_t{m_settings.restoreSamples} << m_knobs[m_lowered.back()].backoff))
+        changed = restore();
+
+    if (changed)
+    {
+        m_overloaded = 0;
+        m_idle       = 0;
+        m_cooldown   = m_settings.cooldownSamples;
+    }
+
+    return changed;
+}
+
+void PerformanceGovernor::setListener(Listener listener)
+{
+    m_listener = std::move(listener);
+}
+
+PerformanceGovernor::Duration PerformanceGovernor::getSmoothedTime() const
+{
+    return std::chrono::duration_cast<Duration>(std::chrono::duration<float, std::micro>(m_smoothed));
+}
+
+void PerformanceGovernor::reset()
+{
+    for (auto& knob : m_knobs)
+    {
+        knob.backoff  = 0;
+        knob.restored = false;
+
+        if (knob.level == 0)
+            continue;
+
+        const std::size_t oldLevel = knob.level;
+        knob.level                 = 0;
+        notify(knob, oldLevel);
+    }
+
+    m_lowered.clear();
+    m_overloaded = 0;
+    m_idle       = 0;
+    m_cooldown   = 0;
+}
+
+bool PerformanceGovernor::degrade()
+{
+    for (KnobId id = 0; id < m_knobs.size(); ++id)
+    {
+        Knob& knob = m_knobs[id];
+        if (knob.level + 1 >= knob.values.size())
+            continue;
+
+        // Lowered again soon after being raised: the raise was premature
+        if (knob.restored)
+        {
+            knob.restored = false;
+            knob.backoff  = std::min(knob.backoff + 1, m_settings.maxBackoff);
+        }
+
+        ++knob.level;
+        m_lowered.push_back(id);
+        notify(knob, knob.level - 1);
+        return true;
+    }
+
+    // Everything is already at its cheapest
+    return false;
+}
+
+bool PerformanceGovernor::restore()
+{
+    if (m_lowered.empty())
+        return false;
+
+    Knob& knob = m_knobs[m_lowered.back()];
+    m_lowered.pop_back();
+
+    --knob.level;
+    knob.restored   = true;
+    knob.restoredAt = m_samples;
+    notify(knob, knob.level + 1);
+    return true;
+}
+
+void PerformanceGovernor::notify(Knob& knob, std::size_t oldLevel)
+{
+    if (m_listener)
+        m_listener({knob.name, oldLevel, knob.level, knob.values[knob.level], getSmoothedTime()});
+}
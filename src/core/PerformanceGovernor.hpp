@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Sheds optional work when frame or tick time runs over budget
+///
+/// Knobs are registered in the order they should be lowered,
+/// cheapest loss first (e.g. particle cap, then dynamic lights,
+/// fluid substeps, far-AI rate, mesh upload budget). Each knob
+/// has a list of values from best quality to cheapest. The
+/// governor smooths the measured time and, when it stays over
+/// budget, moves the first knob that can still drop one step
+/// down. When it stays well under budget it raises the most
+/// recently lowered knob again. Separate thresholds, sustain
+/// counts and a cooldown give it hysteresis so it does not
+/// oscillate around the budget. If raising a knob pushes the
+/// time back over budget and the knob is lowered again, the
+/// idle time needed to raise it next doubles, until it has
+/// stayed raised for a stable period.
+////////////////////////////////////////////////////////////
+class PerformanceGovernor
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+    using KnobId   = std::size_t;
+
+    struct Settings
+    {
+        Duration      budget          = std::chrono::microseconds(16667);
+        float         degradeRatio    = 1.0f;  ///< Smoothed time above budget * this counts as overloaded
+        float         restoreRatio    = 0.7f;  ///< Smoothed time below budget * this counts as idle
+        std::uint32_t degradeSamples  = 5;     ///< Consecutive overloaded samples before lowering
+        std::uint32_t restoreSamples  = 120;   ///< Consecutive idle samples before raising
+        std::uint32_t cooldownSamples = 30;    ///< Samples to wait after any change
+        float         smoothing       = 0.2f;  ///< Weight of the newest sample in the moving average
+        std::uint32_t stableSamples   = 600;   ///< Samples a raised knob must hold before its backoff resets
+        std::uint32_t maxBackoff      = 5;     ///< Cap on restore backoff doublings (120 << 5 samples)
+    };
+
+    struct KnobChange
+    {
+        std::string name;
+        std::size_t oldLevel;
+        std::size_t newLevel;
+        int         value;         ///< Knob value after the change
+        Duration    smoothedTime;  ///< Measurement that triggered it
+    };
+
+    using Listener = std::function<void(const KnobChange&)>;
+
+    PerformanceGovernor();
+
+    explicit PerformanceGovernor(const Settings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// Register a knob
+    ///
+    /// \param name   Label reported in knob change events
+    /// \param values Values from best quality to cheapest, at least one
+    ////////////////////////////////////////////////////////////
+    KnobId addKnob(std::string name, std::vector<int> values);
+
+    ////////////////////////////////////////////////////////////
+    /// Current value of a knob, read by the system it controls
+    ////////////////////////////////////////////////////////////
+    int getValue(KnobId knob) const;
+
+    std::size_t getLevel(KnobId knob) const;
+
+    ////////////////////////////////////////////////////////////
+    /// Feed the time the last frame or tick took
+    ///
+    /// \return True if a knob changed
+    ////////////////////////////////////////////////////////////
+    bool addSample(Duration frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// Called on every knob change, e.g. to emit a trace marker
+    ////////////////////////////////////////////////////////////
+    void setListener(Listener listener);
+
+    Duration getSmoothedTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// Put every knob back to full quality
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private:
+    struct Knob
+    {
+        std::string      name;
+        std::vector<int> values;
+        std::size_t      level;
+        std::uint32_t    backoff    = 0;     ///< Restore samples are shifted left by this
+        bool             restored   = false; ///< Raised and not yet stable
+        std::uint64_t    restoredAt = 0;     ///< Sample index of the last raise
+    };
+
+    bool degrade();
+    bool restore();
+    void notify(Knob& knob, std::size_t oldLevel);
+
+    Settings            m_settings;
+    std::vector<Knob>   m_knobs;
+    std::vector<KnobId> m_lowered;         ///< Stack of lowered knobs, most recent last
+    Listener            m_listener;
+    float               m_smoothed  = 0.f; ///< Moving average in microseconds
+    bool                m_hasSample = false;
+    std::uint32_t       m_overloaded = 0;
+    std::uint32_t       m_idle       = 0;
+    std::uint32_t       m_cooldown   = 0;
+    std::uint64_t       m_samples    = 0; ///< Samples seen, used to age restores
+};
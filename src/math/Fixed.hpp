@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////
+/// Signed fixed-point number stored in a 32-bit integer
+///
+/// Every operation is integer arithmetic, so results are bit
+/// identical on every compiler, flag set and CPU. Use it for
+/// anything the server and clients must agree on, and convert
+/// to float only for rendering.
+///
+/// \tparam FractionBits Bits after the binary point; the default
+///         Q16.16 covers +/-32768 with a step of 1/65536
+////////////////////////////////////////////////////////////
+template <int FractionBits = 16>
+class Fixed
+{
+    static_assert(FractionBits > 0 && FractionBits < 31, "Fixed needs integer and fraction bits");
+
+public:
+    static constexpr int          Bits = FractionBits;
+    static constexpr std::int32_t One  = std::int32_t{1} << FractionBits;
+
+    constexpr Fixed() = default;
+
+    static constexpr int MinInt = -(1 << (31 - FractionBits));
+    static constexpr int MaxInt = (1 << (31 - FractionBits)) - 1;
+
+    constexpr Fixed(int value) : m_raw(static_cast<std::int32_t>(static_cast<std::uint32_t>(value) << FractionBits))
+    {
+        // Out of range values would wrap silently, e.g. Fixed16(40000)
+        assert(value >= MinInt && value <= MaxInt && "integer out of fixed-point range");
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Floating-point input would silently truncate through the
+    /// int constructor; go through fromFloat() instead
+    ////////////////////////////////////////////////////////////
+    Fixed(float)  = delete;
+    Fixed(double) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// Wrap an already scaled raw value
+    ////////////////////////////////////////////////////////////
+    static constexpr Fixed fromRaw(std::int32_t raw)
+    {
+        Fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Convert from float; only use this for data loaded from
+    /// disk or tuning constants, never inside the simulation
+    ////////////////////////////////////////////////////////////
+    static constexpr Fixed fromFloat(float value)
+    {
+        const float scaled = value * static_cast<float>(One);
+        return fromRaw(static_cast<std::int32_t>(scaled < 0.f ? scaled - 0.5f : scaled + 0.5f));
+    }
+
+    constexpr std::int32_t raw() const
+    {
+        return m_raw;
+    }
+
+    constexpr float toFloat() const
+    {
+        return static_cast<float>(m_raw) / static_cast<float>(One);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Round towards negative infinity, like a tile coordinate
+    ////////////////////////////////////////////////////////////
+    constexpr int floor() const
+    {
+        return m_raw >> FractionBits;
+    }
+
+    constexpr Fixed operator-() const
+    {
+        return fromRaw(-m_raw);
+    }
+
+    constexpr Fixed& operator+=(Fixed other)
+    {
+        m_raw += other.m_raw;
+        return *this;
+    }
+
+    constexpr Fixed& operator-=(Fixed other)
+    {
+        m_raw -= other.m_raw;
+        return *this;
+    }
+
+    constexpr Fixed& operator*=(Fixed other)
+    {
+        // Widen, multiply, then drop the extra fraction bits
+        m_raw = static_cast<std::int32_t>((static_cast<std::int64_t>(m_raw) * other.m_raw) >> FractionBits);
+        return *this;
+    }
+
+    constexpr Fixed& operator/=(Fixed other)
+    {
+        m_raw = static_cast<std::int32_t>((static_cast<std::int64_t>(m_raw) * One) / other.m_raw);
+        return *this;
+    }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return a += b; }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return a -= b; }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) { return a *= b; }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) { return a /= b; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b)  { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b)  { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.m_raw >= b.m_raw; }
+
+private:
+    std::int32_t m_raw = 0;
+};
+
+using Fixed16 = Fixed<16>;
+
+////////////////////////////////////////////////////////////
+/// Absolute value
+////////////////////////////////////////////////////////////
+template <int F>
+constexpr Fixed<F> abs(Fixed<F> value)
+{
+    return value.raw() < 0 ? -value : value;
+}
+
+////////////////////////////////////////////////////////////
+/// Square root, exact to the last bit; negative input gives 0
+///
+/// Digit-by-digit integer square root of the value shifted up by
+/// the fraction bits, so it needs no float and no lookup table.
+/// On GCC and Clang the loop starts at the input's top set bit,
+/// so small values take fewer iterations than large ones; the
+/// result is the same either way.
+////////////////////////////////////////////////////////////
+template <int F>
+constexpr Fixed<F> sqrt(Fixed<F> value)
+{
+    if (value.raw() <= 0)
+        return Fixed<F>();
+
+    std::uint64_t remainder = static_cast<std::uint64_t>(value.raw()) << F;
+    std::uint64_t root      = 0;
+
+    // Start at the highest even bit not above the input's top bit
+#if defined(__GNUC__) || defined(__clang__)
+    std::uint64_t bit = std::uint64_t{1} << ((63 - __builtin_clzll(remainder)) & ~1);
+#else
+    std::uint64_t bit = std::uint64_t{1} << 62;
+    while (bit > remainder)
+        bit >>= 2;
+#endif
+
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return Fixed<F>::fromRaw(static_cast<std::int32_t>(root));
+}
+
+////////////////////////////////////////////////////////////
+/// Two-component fixed-point vector
+////////////////////////////////////////////////////////////
+template <int F = 16>
+struct FixedVector2
+{
+    Fixed<F> x;
+    Fixed<F> y;
+
+    constexpr FixedVector2() = default;
+
+    constexpr FixedVector2(Fixed<F> xValue, Fixed<F> yValue) : x(xValue), y(yValue)
+    {
+    }
+
+    constexpr FixedVector2& operator+=(const FixedVector2& other)
+    {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
+
+    constexpr FixedVector2& operator-=(const FixedVector2& other)
+    {
+        x -= other.x;
+        y -= other.y;
+        return *this;
+    }
+
+    constexpr FixedVector2& operator*=(Fixed<F> scale)
+    {
+        x *= scale;
+        y *= scale;
+        return *this;
+    }
+
+    friend constexpr FixedVector2 operator+(FixedVector2 a, const FixedVector2& b) { return a += b; }
+    friend constexpr FixedVector2 operator-(FixedVector2 a, const FixedVector2& b) { return a -= b; }
+    friend constexpr FixedVector2 operator*(FixedVector2 a, Fixed<F> scale)       { return a *= scale; }
+    friend constexpr FixedVector2 operator-(const FixedVector2& a)                 { return {-a.x, -a.y}; }
+
+    friend constexpr bool operator==(const FixedVector2& a, const FixedVector2& b) { return a.x == b.x && a.y == b.y; }
+    friend constexpr bool operator!=(const FixedVector2& a, const FixedVector2& b) { return !(a == b); }
+
+    constexpr Fixed<F> dot(const FixedVector2& other) const
+    {
+        // Accumulate at full precision and round once, so dot products
+        // of short vectors do not lose both products' low bits
+        const std::int64_t sum = static_cast<std::int64_t>(x.raw()) * other.x.raw() +
+                                 static_cast<std::int64_t>(y.raw()) * other.y.raw();
+        return Fixed<F>::fromRaw(static_cast<std::int32_t>(sum >> F));
+    }
+
+    constexpr Fixed<F> lengthSquared() const
+    {
+        return dot(*this);
+    }
+
+    constexpr Fixed<F> length() const
+    {
+        return sqrt(lengthSquared());
+    }
+};
+
+using FixedVector2f = FixedVector2<16>;
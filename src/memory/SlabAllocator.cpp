@@ -0,0 +1,153 @@
+#include "SlabAllocator.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define SLAB_USE_MMAP 1
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace
+{
+constexpr std::size_t BlockAlignment = 64;
+constexpr std::size_t HugePageSize   = 2 * 1024 * 1024;
+
+std::size_t roundUp(std::size_t value, std::size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+} // namespace
+
+SlabAllocator::SlabAllocator(std::size_t blockSize, std::size_t slabSize) :
+m_blockSize(roundUp(blockSize < sizeof(void*) ? sizeof(void*) : blockSize, BlockAlignment)),
+m_slabSize(roundUp(slabSize < m_blockSize ? m_blockSize : slabSize, HugePageSize))
+{
+}
+
+SlabAllocator::~SlabAllocator()
+{
+    for (const auto& slab : m_slabs)
+    {
+#if defined(SLAB_USE_MMAP)
+        munmap(slab.memory, slab.size);
+#elif defined(_WIN32)
+        _aligned_free(slab.memory);
+#else
+        std::free(slab.memory);
+#endif
+    }
+}
+
+void* SlabAllocator::allocate()
+{
+    if (!m_freeList && !addSlab())
+        return nullptr;
+
+    void* block = m_freeList;
+    m_freeList  = *static_cast<void**>(block);
+
+    ++m_stats.blocksInUse;
+    if (m_stats.blocksInUse > m_stats.peakBlocks)
+        m_stats.peakBlocks = m_stats.blocksInUse;
+
+    return block;
+}
+
+void SlabAllocator::deallocate(void* block)
+{
+    if (!block)
+        return;
+
+    assert(m_stats.blocksInUse > 0);
+
+    *static_cast<void**>(block) = m_freeList;
+    m_freeList                  = block;
+    --m_stats.blocksInUse;
+}
+
+std::size_t SlabAllocator::getBlockSize() const
+{
+    return m_blockSize;
+}
+
+const SlabAllocator::Stats& SlabAllocator::getStats() const
+{
+    return m_stats;
+}
+
+bool SlabAllocator::addSlab()
+{
+    void* memory  = nullptr;
+    bool  hugeTlb = false;
+
+#ifdef SLAB_USE_MMAP
+#ifdef MAP_HUGETLB
+    // Only succeeds if huge pages were reserved (vm.nr_hugepages)
+    memory = mmap(nullptr, m_slabSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory == MAP_FAILED)
+        memory = nullptr;
+    else
+        hugeTlb = true;
+#endif
+
+    if (!memory)
+    {
+        // THP can only back 2 MiB-aligned ranges, and kernels before 6.7 do
+        // not align large anonymous mappings: map one huge page extra and
+        // trim the unaligned head and the leftover tail
+        const std::size_t mappedSize = m_slabSize + HugePageSize;
+        void* const mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+            return false;
+
+        const auto start   = reinterpret_cast<std::uintptr_t>(mapped);
+        const auto aligned = (start + HugePageSize - 1) & ~static_cast<std::uintptr_t>(HugePageSize - 1);
+        const auto head    = static_cast<std::size_t>(aligned - start);
+        const auto tail    = mappedSize - head - m_slabSize;
+
+        if (head > 0)
+            munmap(mapped, head);
+        if (tail > 0)
+            munmap(reinterpret_cast<void*>(aligned + m_slabSize), tail);
+
+        memory = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+        // A hint only; ignored when transparent huge pages are disabled
+        madvise(memory, m_slabSize, MADV_HUGEPAGE);
+#endif
+    }
+#elif defined(_WIN32)
+    memory = _aligned_malloc(m_slabSize, BlockAlignment);
+    if (!memory)
+        return false;
+#else
+    memory = std::aligned_alloc(BlockAlignment, m_slabSize);
+    if (!memory)
+        return false;
+#endif
+
+    m_slabs.push_back({memory, m_slabSize, hugeTlb});
+
+    // Thread the new blocks onto the free list in address order, so
+    // consecutive allocations are adjacent in memory
+    auto* const       base  = static_cast<unsigned char*>(memory);
+    const std::size_t count = m_slabSize / m_blockSize;
+    for (std::size_t i = count; i-- > 0;)
+    {
+        void* block                 = base + i * m_blockSize;
+        *static_cast<void**>(block) = m_freeList;
+        m_freeList                  = block;
+    }
+
+    ++m_stats.slabCount;
+    m_stats.bytesReserved += m_slabSize;
+    if (hugeTlb)
+        ++m_stats.hugeTlbSlabs;
+
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Fixed-size block allocator backed by large mapped slabs
+///
+/// Meant for chunk storage: every block has the same size, so
+/// blocks are carved out of big slabs and recycled through an
+/// intrusive free list, with no per-block header and no heap
+/// fragmentation. On Linux slabs are mapped with MAP_HUGETLB
+/// when huge pages are reserved, otherwise marked for
+/// transparent huge pages, so a world-wide pass over resident
+/// chunks touches a handful of TLB entries instead of thousands.
+/// Other platforms take slabs from the aligned heap.
+///
+/// Not thread-safe; guard it or keep one per thread.
+////////////////////////////////////////////////////////////
+class SlabAllocator
+{
+public:
+    struct Stats
+    {
+        std::size_t slabCount     = 0;
+        std::size_t hugeTlbSlabs  = 0; ///< Slabs backed by reserved huge pages
+        std::size_t blocksInUse   = 0;
+        std::size_t peakBlocks    = 0;
+        std::size_t bytesReserved = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \param blockSize Size of each block, rounded up to 64 bytes
+    /// \param slabSize  Bytes per slab, rounded up to 2 MiB
+    ////////////////////////////////////////////////////////////
+    explicit SlabAllocator(std::size_t blockSize, std::size_t slabSize = 2 * 1024 * 1024);
+
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&)            = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// Get an uninitialised block, 64-byte aligned
+    ///
+    /// \return Null if a new slab could not be mapped
+    ////////////////////////////////////////////////////////////
+    void* allocate();
+
+    ////////////////////////////////////////////////////////////
+    /// Return a block obtained from allocate()
+    ////////////////////////////////////////////////////////////
+    void deallocate(void* block);
+
+    std::size_t getBlockSize() const;
+
+    const Stats& getStats() const;
+
+private:
+    struct Slab
+    {
+        void*       memory;
+        std::size_t size;
+        bool        hugeTlb;
+    };
+
+    bool addSlab();
+
+    std::size_t       m_blockSize;
+    std::size_t       m_slabSize;
+    void*             m_freeList = nullptr; ///< Each free block stores the next one
+    std::vector<Slab> m_slabs;
+    Stats             m_stats;
+};
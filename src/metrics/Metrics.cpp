@@ -0,0 +1,220 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+namespace
+{
+// The text format escapes backslash and newline in HELP, and also double
+// quotes in label values
+std::string escape(const std::string& text, bool quotes)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (const char c : text)
+    {
+        if (c == '\\')
+            result += "\\\\";
+        else if (c == '\n')
+            result += "\\n";
+        else if (c == '"' && quotes)
+            result += "\\\"";
+        else
+            result += c;
+    }
+    return result;
+}
+
+std::string renderLabels(const MetricsRegistry::Labels& labels)
+{
+    std::string result;
+    for (const auto& [key, value] : labels)
+    {
+        if (!result.empty())
+            result += ',';
+
+        result += key;
+        result += "=\"";
+        result += escape(value, true);
+        result += '"';
+    }
+    return result;
+}
+
+// Join the series labels with an extra one such as le="100"
+std::string withLabel(const std::string& labels, const std::string& extra)
+{
+    return labels.empty() ? extra : labels + ',' + extra;
+}
+
+void writeSample(std::ostringstream& out, const std::string& name, const std::string& labels, const std::string& value)
+{
+    out << name;
+    if (!labels.empty())
+        out << '{' << labels << '}';
+    out << ' ' << value << '\n';
+}
+} // namespace
+
+MetricsHistogram::MetricsHistogram(std::vector<std::uint64_t> bounds) :
+m_bounds(std::move(bounds)),
+m_buckets(new std::atomic<std::uint64_t>[m_bounds.size() + 1])
+{
+    assert(std::is_sorted(m_bounds.begin(), m_bounds.end()));
+
+    for (std::size_t i = 0; i <= m_bounds.size(); ++i)
+        m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricsHistogram::observe(std::uint64_t value)
+{
+    const auto bucket = static_cast<std::size_t>(std::lower_bound(m_bounds.begin(), m_bounds.end(), value) -
+                                                 m_bounds.begin());
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+const std::vector<std::uint64_t>& MetricsHistogram::getBounds() const
+{
+    return m_bounds;
+}
+
+std::uint64_t MetricsHistogram::getBucketCount(std::size_t index) const
+{
+    return m_buckets[index].load(std::memory_order_relaxed);
+}
+
+std::uint64_t MetricsHistogram::getSum() const
+{
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+MetricsCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Series& series = findOrAdd(name, help, Type::Counter, labels);
+    if (!series.counter)
+        series.counter = std::make_unique<MetricsCounter>();
+
+    return *series.counter;
+}
+
+MetricsGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Series& series = findOrAdd(name, help, Type::Gauge, labels);
+    if (!series.gauge)
+        series.gauge = std::make_unique<MetricsGauge>();
+
+    return *series.gauge;
+}
+
+MetricsHistogram& MetricsRegistry::histogram(const std::string&         name,
+                                             const std::string&         help,
+                                             std::vector<std::uint64_t> bounds,
+                                             const Labels&              labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Series& series = findOrAdd(name, help, Type::Histogram, labels);
+    if (!series.histogram)
+        series.histogram = std::make_unique<MetricsHistogram>(std::move(bounds));
+
+    return *series.histogram;
+}
+
+void MetricsRegistry::remove(const std::string& name, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto family = std::find_if(m_families.begin(), m_families.end(),
+                                     [&name](const Family& entry) { return entry.name == name; });
+    if (family == m_families.end())
+        return;
+
+    const std::string key = renderLabels(labels);
+    family->series.erase(std::remove_if(family->series.begin(), family->series.end(),
+                                        [&key](const Series& entry) { return entry.labels == key; }),
+                         family->series.end());
+}
+
+std::string MetricsRegistry::render() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::ostringstream out;
+    for (const auto& family : m_families)
+    {
+        static const char* const typeNames[] = {"counter", "gauge", "histogram"};
+
+        out << "# HELP " << family.name << ' ' << escape(family.help, false) << '\n';
+        out << "# TYPE " << family.name << ' ' << typeNames[static_cast<int>(family.type)] << '\n';
+
+        for (const auto& series : family.series)
+        {
+            switch (family.type)
+            {
+                case Type::Counter:
+                    writeSample(out, family.name, series.labels, std::to_string(series.counter->get()));
+                    break;
+
+                case Type::Gauge:
+                    writeSample(out, family.name, series.labels, std::to_string(series.gauge->get()));
+                    break;
+
+                case Type::Histogram:
+                {
+                    // Prometheus buckets are cumulative
+                    const MetricsHistogram& histogram  = *series.histogram;
+                    const auto&             bounds     = histogram.getBounds();
+                    std::uint64_t           cumulative = 0;
+
+                    for (std::size_t i = 0; i < bounds.size(); ++i)
+                    {
+                        cumulative += histogram.getBucketCount(i);
+                        writeSample(out, family.name + "_bucket",
+                                    withLabel(series.labels, "le=\"" + std::to_string(bounds[i]) + '"'),
+                                    std::to_string(cumulative));
+                    }
+
+                    cumulative += histogram.getBucketCount(bounds.size());
+                    writeSample(out, family.name + "_bucket", withLabel(series.labels, "le=\"+Inf\""),
+                                std::to_string(cumulative));
+                    writeSample(out, family.name + "_sum", series.labels, std::to_string(histogram.getSum()));
+                    writeSample(out, family.name + "_count", series.labels, std::to_string(cumulative));
+                    break;
+                }
+            }
+        }
+    }
+
+    return out.str();
+}
+
+MetricsRegistry::Series& MetricsRegistry::findOrAdd(const std::string& name,
+                                                    const std::string& help,
+                                                    Type               type,
+                                                    const Labels&      labels)
+{
+    auto family = std::find_if(m_families.begin(), m_families.end(),
+                               [&name](const Family& entry) { return entry.name == name; });
+    if (family == m_families.end())
+    {
+        m_families.push_back({name, help, type, {}});
+        family = m_families.end() - 1;
+    }
+
+    assert(family->type == type && "metric registered again with a different type");
+
+    std::string key    = renderLabels(labels);
+    const auto  series = std::find_if(family->series.begin(), family->series.end(),
+                                      [&key](const Series& entry) { return entry.labels == key; });
+    if (series != family->series.end())
+        return *series;
+
+    family->series.push_back({std::move(key), nullptr, nullptr, nullptr});
+    return family->series.back();
+}
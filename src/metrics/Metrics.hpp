@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Monotonic counter; add() is one relaxed atomic add
+////////////////////////////////////////////////////////////
+class MetricsCounter
+{
+public:
+    void add(std::uint64_t amount = 1)
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    std::uint64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> m_value{0};
+};
+
+////////////////////////////////////////////////////////////
+/// Value that can go up and down, e.g. loaded chunks
+////////////////////////////////////////////////////////////
+class MetricsGauge
+{
+public:
+    void set(std::int64_t value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void add(std::int64_t amount)
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    std::int64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::int64_t> m_value{0};
+};
+
+////////////////////////////////////////////////////////////
+/// Bucketed distribution, e.g. tick time
+///
+/// observe() is a short search over the bucket bounds plus two
+/// relaxed atomic adds. Values are integers in the caller's
+/// unit (microseconds for times, bytes for sizes) so the sum
+/// stays a plain atomic add. Percentiles are derived from the
+/// buckets by the monitoring side (histogram_quantile).
+////////////////////////////////////////////////////////////
+class MetricsHistogram
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \param bounds Inclusive upper bounds, ascending; an
+    ///        overflow bucket is added after the last one
+    ////////////////////////////////////////////////////////////
+    explicit MetricsHistogram(std::vector<std::uint64_t> bounds);
+
+    void observe(std::uint64_t value);
+
+    const std::vector<std::uint64_t>& getBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// Non-cumulative count of bucket \a index; the last index
+    /// (equal to getBounds().size()) is the overflow bucket
+    ////////////////////////////////////////////////////////////
+    std::uint64_t getBucketCount(std::size_t index) const;
+
+    std::uint64_t getSum() const;
+
+private:
+    std::vector<std::uint64_t>                       m_bounds;
+    std::unique_ptr<std::atomic<std::uint64_t>[]>    m_buckets;
+    std::atomic<std::uint64_t>                       m_sum{0};
+};
+
+////////////////////////////////////////////////////////////
+/// Owns every metric and renders them in Prometheus text format
+///
+/// Registration takes a lock and should happen once, at startup
+/// or when a client connects; keep the returned reference and
+/// update it directly on the hot path. References stay valid
+/// for the lifetime of the registry. Asking again for the same
+/// name and labels returns the existing metric.
+////////////////////////////////////////////////////////////
+class MetricsRegistry
+{
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    MetricsCounter& counter(const std::string& name, const std::string& help, const Labels& labels = {});
+
+    MetricsGauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+
+    MetricsHistogram& histogram(const std::string& name,
+                                const std::string& help,
+                                std::vector<std::uint64_t> bounds,
+                                const Labels&              labels = {});
+
+    ////////////////////////////////////////////////////////////
+    /// Drop a labelled metric, e.g. a disconnected client's bandwidth
+    ///
+    /// The caller must make sure nothing still updates it.
+    ////////////////////////////////////////////////////////////
+    void remove(const std::string& name, const Labels& labels);
+
+    ////////////////////////////////////////////////////////////
+    /// Render every metric in Prometheus text exposition format
+    ////////////////////////////////////////////////////////////
+    std::string render() const;
+
+private:
+    enum class Type
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Series
+    {
+        std::string                       labels; ///< Pre-rendered, e.g. client="3"
+        std::unique_ptr<MetricsCounter>   counter;
+        std::unique_ptr<MetricsGauge>     gauge;
+        std::unique_ptr<MetricsHistogram> histogram;
+    };
+
+    struct Family
+    {
+        std::string         name;
+        std::string         help;
+        Type                type;
+        std::vector<Series> series;
+    };
+
+    Series& findOrAdd(const std::string& name, const std::string& help, Type type, const Labels& labels);
+
+    mutable std::mutex  m_mutex;
+    std::vector<Family> m_families;
+};
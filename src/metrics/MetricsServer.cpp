@@ -0,0 +1,199 @@
+#include "MetricsServer.hpp"
+
+#include "Metrics.hpp"
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define METRICS_SERVER_POSIX 1
+
+// Linux suppresses SIGPIPE per call, macOS per socket (SO_NOSIGPIPE)
+#ifdef MSG_NOSIGNAL
+#define METRICS_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define METRICS_SEND_FLAGS 0
+#endif
+#endif
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry) : m_registry(registry)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+bool MetricsServer::startTcp(std::uint16_t port)
+{
+#ifdef METRICS_SERVER_POSIX
+    if (m_running)
+        return false;
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        return false;
+
+    const int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(listener);
+        return false;
+    }
+
+    return start(listener);
+#else
+    (void)port;
+    return false;
+#endif
+}
+
+bool MetricsServer::startUnix(const std::string& path)
+{
+#ifdef METRICS_SERVER_POSIX
+    sockaddr_un address{};
+    if (m_running || path.size() >= sizeof(address.sun_path))
+        return false;
+
+    // A crashed server leaves its socket file behind; remove that, but
+    // never a regular file or anything else that happens to be at the path
+    struct stat info{};
+    if (::lstat(path.c_str(), &info) == 0)
+    {
+        if (!S_ISSOCK(info.st_mode))
+            return false;
+
+        ::unlink(path.c_str());
+    }
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        return false;
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(listener);
+        return false;
+    }
+
+    m_unixPath = path;
+    return start(listener);
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void MetricsServer::stop()
+{
+    if (!m_running.exchange(false))
+        return;
+
+    // The thread polls with a timeout, so it notices the flag and exits
+    if (m_thread.joinable())
+        m_thread.join();
+
+#ifdef METRICS_SERVER_POSIX
+    ::close(m_socket);
+    if (!m_unixPath.empty())
+        ::unlink(m_unixPath.c_str());
+#endif
+
+    m_socket = -1;
+    m_unixPath.clear();
+}
+
+bool MetricsServer::isRunning() const
+{
+    return m_running;
+}
+
+bool MetricsServer::start(int socket)
+{
+#ifdef METRICS_SERVER_POSIX
+    if (::listen(socket, 8) != 0)
+    {
+        ::close(socket);
+        m_unixPath.clear();
+        return false;
+    }
+
+    m_socket  = socket;
+    m_running = true;
+    m_thread  = std::thread(&MetricsServer::run, this);
+    return true;
+#else
+    (void)socket;
+    return false;
+#endif
+}
+
+void MetricsServer::run()
+{
+#ifdef METRICS_SERVER_POSIX
+    while (m_running)
+    {
+        pollfd descriptor{m_socket, POLLIN, 0};
+        if (::poll(&descriptor, 1, 200) <= 0)
+            continue;
+
+        const int client = ::accept(m_socket, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+        // A scraper that connects and never reads must not stall the thread,
+        // or stop() would hang on join()
+        timeval timeout{};
+        timeout.tv_sec = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+        // The request itself does not matter: every path returns the metrics.
+        // Read what has arrived so closing does not reset the connection.
+        char request[1024];
+        pollfd clientDescriptor{client, POLLIN, 0};
+        if (::poll(&clientDescriptor, 1, 100) > 0)
+            (void)::recv(client, request, sizeof(request), 0);
+
+        const std::string body     = m_registry.render();
+        const std::string response = "HTTP/1.0 200 OK\r\n"
+                                     "Content-Type: text/plain; version=0.0.4\r\n"
+                                     "Content-Length: " +
+                                     std::to_string(body.size()) + "\r\n\r\n" + body;
+
+        std::size_t sent = 0;
+        while (sent < response.size() && m_running)
+        {
+            const auto result = ::send(client, response.data() + sent, response.size() - sent, METRICS_SEND_FLAGS);
+            if (result <= 0)
+                break;
+            sent += static_cast<std::size_t>(result);
+        }
+
+        ::close(client);
+    }
+#endif
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+class MetricsRegistry;
+
+////////////////////////////////////////////////////////////
+/// Serves a registry's metrics to a local scraper
+///
+/// Listens on 127.0.0.1 or a Unix socket path and answers each
+/// connection with one HTTP response holding the Prometheus
+/// text, on its own thread so the game thread never blocks on
+/// a slow scraper. It never listens on a public interface; put
+/// a reverse proxy or node exporter in front for remote access.
+/// Only available on POSIX systems; start() fails elsewhere.
+////////////////////////////////////////////////////////////
+class MetricsServer
+{
+public:
+    explicit MetricsServer(const MetricsRegistry& registry);
+
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&)            = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// Listen on 127.0.0.1:\a port
+    ////////////////////////////////////////////////////////////
+    bool startTcp(std::uint16_t port);
+
+    ////////////////////////////////////////////////////////////
+    /// Listen on a Unix socket, replacing a stale socket file
+    ////////////////////////////////////////////////////////////
+    bool startUnix(const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    /// Stop serving and join the thread; safe to call twice
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    bool isRunning() const;
+
+private:
+    bool start(int socket);
+    void run();
+
+    const MetricsRegistry& m_registry;
+    std::thread            m_thread;
+    std::atomic<bool>      m_running{false};
+    int                    m_socket = -1;
+    std::string            m_unixPath;
+};
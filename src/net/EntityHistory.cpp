@@ -0,0 +1,107 @@
+#include "EntityHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+EntityHistory::EntityHistory(std::size_t ticks) : m_snapshots(std::max<std::size_t>(ticks, 1))
+{
+}
+
+void EntityHistory::beginTick(Tick tick)
+{
+    assert(m_recording == NotRecording && "beginTick() called twice without endTick()");
+    assert((!m_hasTicks || tick > m_newest) && "ticks must be recorded in order");
+
+    // The vector keeps its capacity, so after warm-up recording allocates nothing
+    m_recording        = tick % m_snapshots.size();
+    Snapshot& snapshot = m_snapshots[m_recording];
+    snapshot.tick      = tick;
+    snapshot.valid     = false;
+    snapshot.samples.clear();
+}
+
+void EntityHistory::record(EntityId id, Position position)
+{
+    assert(m_recording != NotRecording);
+    m_snapshots[m_recording].samples.push_back({id, position});
+}
+
+void EntityHistory::endTick()
+{
+    assert(m_recording != NotRecording);
+
+    Snapshot& snapshot = m_snapshots[m_recording];
+    auto&     samples  = snapshot.samples;
+
+    // Entities are usually iterated in id order already, so check before sorting
+    const auto byId = [](const Sample& a, const Sample& b) { return a.id < b.id; };
+    if (!std::is_sorted(samples.begin(), samples.end(), byId))
+        std::sort(samples.begin(), samples.end(), byId);
+
+    snapshot.valid = true;
+    m_newest       = snapshot.tick;
+    m_hasTicks     = true;
+    m_recording    = NotRecording;
+
+    // Skipped ticks leave older snapshots behind in unused slots, so the
+    // oldest held tick has to come from the ring rather than from m_newest
+    m_oldest = m_newest;
+    for (const auto& entry : m_snapshots)
+    {
+        if (entry.valid && entry.tick < m_oldest)
+            m_oldest = entry.tick;
+    }
+}
+
+bool EntityHistory::positionAt(Tick tick, EntityId id, Position& position) const
+{
+    if (!contains(tick))
+        return false;
+
+    const Snapshot& snapshot = m_snapshots[tick % m_snapshots.size()];
+
+    const auto it = std::lower_bound(snapshot.samples.begin(), snapshot.samples.end(), id,
+                                     [](const Sample& sample, EntityId value) { return sample.id < value; });
+    if (it == snapshot.samples.end() || it->id != id)
+        return false;
+
+    position = it->position;
+    return true;
+}
+
+bool EntityHistory::positionAt(Tick tick, Fixed16 alpha, EntityId id, Position& position) const
+{
+    Position from;
+    if (!positionAt(tick, id, from))
+        return false;
+
+    Position to;
+    if (alpha <= Fixed16(0) || !positionAt(tick + 1, id, to))
+    {
+        position = from;
+        return true;
+    }
+
+    alpha    = std::min(alpha, Fixed16(1));
+    position = from + (to - from) * alpha;
+    return true;
+}
+
+EntityHistory::Tick EntityHistory::oldestTick() const
+{
+    return m_oldest;
+}
+
+EntityHistory::Tick EntityHistory::newestTick() const
+{
+    return m_newest;
+}
+
+bool EntityHistory::contains(Tick tick) const
+{
+    if (!m_hasTicks || tick < m_oldest || tick > m_newest)
+        return false;
+
+    const Snapshot& snapshot = m_snapshots[tick % m_snapshots.size()];
+    return snapshot.valid && snapshot.tick == tick;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "math/Fixed.hpp"
+
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Rewindable record of entity positions for lag compensation
+///
+/// The server records every entity's position once per tick
+/// into a fixed number of slots reused in a ring. When a client
+/// reports a hit, the server looks the target up at the tick the
+/// client was seeing instead of at the current tick. Each tick's
+/// snapshot is sorted by entity id, so a lookup is one modulo to
+/// find the tick and one binary search to find the entity.
+////////////////////////////////////////////////////////////
+class EntityHistory
+{
+public:
+    using Tick     = std::uint32_t;
+    using EntityId = std::uint32_t;
+
+    using Position = FixedVector2f;
+
+    ////////////////////////////////////////////////////////////
+    /// \param ticks Number of ticks kept, e.g. 1 s at 20 TPS = 20
+    ////////////////////////////////////////////////////////////
+    explicit EntityHistory(std::size_t ticks);
+
+    ////////////////////////////////////////////////////////////
+    /// Start recording a tick, overwriting the slot it maps to
+    ///
+    /// Ticks must be recorded in increasing order but may skip
+    /// numbers, e.g. after a server hitch. Lookups only succeed
+    /// for ticks that were actually recorded and whose slot has
+    /// not been reused since.
+    ////////////////////////////////////////////////////////////
+    void beginTick(Tick tick);
+
+    ////////////////////////////////////////////////////////////
+    /// Record one entity's position for the current tick
+    ////////////////////////////////////////////////////////////
+    void record(EntityId id, Position position);
+
+    ////////////////////////////////////////////////////////////
+    /// Finish the current tick and make it available to lookups
+    ////////////////////////////////////////////////////////////
+    void endTick();
+
+    ////////////////////////////////////////////////////////////
+    /// Position of an entity at a past tick
+    ///
+    /// \return False if the tick has left the window or the
+    ///         entity did not exist at that tick
+    ////////////////////////////////////////////////////////////
+    bool positionAt(Tick tick, EntityId id, Position& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// Position between two recorded ticks
+    ///
+    /// Clients render between snapshots, so their view is at
+    /// \a tick plus \a alpha (0 to 1) of the way to the next
+    /// tick. Falls back to \a tick alone if the next is missing.
+    ////////////////////////////////////////////////////////////
+    bool positionAt(Tick tick, Fixed16 alpha, EntityId id, Position& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// Oldest tick still held, or the newest if nothing is older
+    ///
+    /// With skipped ticks, not every tick between this and
+    /// newestTick() is held; use contains() to check one.
+    ////////////////////////////////////////////////////////////
+    Tick oldestTick() const;
+
+    ////////////////////////////////////////////////////////////
+    /// Most recent completed tick
+    ////////////////////////////////////////////////////////////
+    Tick newestTick() const;
+
+    ////////////////////////////////////////////////////////////
+    /// Whether \a tick was recorded and is still held
+    ////////////////////////////////////////////////////////////
+    bool contains(Tick tick) const;
+
+private:
+    struct Sample
+    {
+        EntityId id;
+        Position position;
+    };
+
+    struct Snapshot
+    {
+        Tick                tick  = 0;
+        bool                valid = false;
+        std::vector<Sample> samples; ///< Sorted by id once the tick ends
+    };
+
+    static constexpr std::size_t NotRecording = static_cast<std::size_t>(-1);
+
+    std::vector<Snapshot> m_snapshots;                ///< Ring indexed by tick % size
+    std::size_t           m_recording = NotRecording; ///< Slot being recorded; an index so copies stay valid
+    Tick                  m_oldest    = 0;
+    Tick                  m_newest    = 0;
+    bool                  m_hasTicks  = false;
+};
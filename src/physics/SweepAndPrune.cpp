@@ -0,0 +1,144 @@
+#include "SweepAndPrune.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+SweepAndPrune::Handle SweepAndPrune::add(const BroadphaseBox& box)
+{
+    Handle handle;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<Handle>(m_slots.size());
+        m_slots.push_back(0);
+    }
+
+    m_slots[handle] = static_cast<std::uint32_t>(m_entries.size());
+    m_entries.push_back({box, handle});
+    ++m_unsorted;
+
+    return handle;
+}
+
+void SweepAndPrune::remove(Handle handle)
+{
+    assert(handle < m_slots.size());
+    assert(m_slots[handle] < m_entries.size() && m_entries[m_slots[handle]].handle == handle &&
+           "handle was already removed");
+
+    // Entries are only marked here and dropped by the next compaction,
+    // so a mass despawn does not shift the array once per removal
+    m_entries[m_slots[handle]].handle = InvalidHandle;
+    m_freeHandles.push_back(handle);
+    ++m_removed;
+}
+
+void SweepAndPrune::update(Handle handle, const BroadphaseBox& box)
+{
+    assert(handle < m_slots.size());
+    assert(m_slots[handle] < m_entries.size() && m_entries[m_slots[handle]].handle == handle &&
+           "handle was removed");
+    m_entries[m_slots[handle]].box = box;
+}
+
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::findPairs()
+{
+    if (m_removed > 0)
+        compact();
+
+    sortEntries();
+
+    m_pairs.clear();
+
+    const std::size_t count = m_entries.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const BroadphaseBox& a = m_entries[i].box;
+
+        for (std::size_t j = i + 1; j < count; ++j)
+        {
+            const BroadphaseBox& b = m_entries[j].box;
+
+            // Sorted by minX: once b starts past a, nothing after it can overlap a
+            if (b.minX > a.maxX)
+                break;
+
+            if (b.minY <= a.maxY && a.minY <= b.maxY)
+            {
+                const Handle first  = m_entries[i].handle;
+                const Handle second = m_entries[j].handle;
+                m_pairs.emplace_back(std::min(first, second), std::max(first, second));
+            }
+        }
+    }
+
+    return m_pairs;
+}
+
+std::size_t SweepAndPrune::size() const
+{
+    return m_entries.size() - m_removed;
+}
+
+void SweepAndPrune::clear()
+{
+    m_entries.clear();
+    m_slots.clear();
+    m_freeHandles.clear();
+    m_pairs.clear();
+    m_unsorted = 0;
+    m_removed  = 0;
+}
+
+void SweepAndPrune::compact()
+{
+    // A removed handle may already have been handed out again by add(), which
+    // points its slot at a new entry; rewriting every live slot below keeps
+    // that consistent
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [](const Entry& entry) { return entry.handle == InvalidHandle; }),
+                    m_entries.end());
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+        m_slots[m_entries[i].handle] = static_cast<std::uint32_t>(i);
+
+    m_removed = 0;
+}
+
+void SweepAndPrune::sortEntries()
+{
+    const auto byMinX = [](const Entry& a, const Entry& b) { return a.box.minX < b.box.minX; };
+
+    // Insertion sort is near linear on the almost sorted array left by the
+    // previous frame, but quadratic on a large batch of fresh entries
+    if (m_unsorted > 64 && m_unsorted * 8 > m_entries.size())
+    {
+        std::sort(m_entries.begin(), m_entries.end(), byMinX);
+    }
+    else
+    {
+        for (std::size_t i = 1; i < m_entries.size(); ++i)
+        {
+            if (!byMinX(m_entries[i], m_entries[i - 1]))
+                continue;
+
+            const Entry moving = m_entries[i];
+            std::size_t j      = i;
+            do
+            {
+                m_entries[j] = m_entries[j - 1];
+                --j;
+            } while (j > 0 && byMinX(moving, m_entries[j - 1]));
+            m_entries[j] = moving;
+        }
+    }
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+        m_slots[m_entries[i].handle] = static_cast<std::uint32_t>(i);
+
+    m_unsorted = 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "math/Fixed.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Axis-aligned box used by the broadphase, in tiles
+///
+/// Fixed-point so the server and every client report exactly
+/// the same pairs for the same positions.
+////////////////////////////////////////////////////////////
+struct BroadphaseBox
+{
+    Fixed16 minX;
+    Fixed16 minY;
+    Fixed16 maxX;
+    Fixed16 maxY;
+};
+
+////////////////////////////////////////////////////////////
+/// Sweep-and-prune broadphase for entity-versus-entity tests
+///
+/// Boxes are kept sorted by their minimum x. Between calls to
+/// findPairs() entities only move a little, so the array stays
+/// almost sorted and an insertion sort restores the order in
+/// close to linear time. The sweep then only compares boxes
+/// whose x intervals overlap and reports the pairs that also
+/// overlap on y, ready for a narrowphase.
+////////////////////////////////////////////////////////////
+class SweepAndPrune
+{
+public:
+    using Handle = std::uint32_t;
+    using Pair   = std::pair<Handle, Handle>;
+
+    static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+
+    ////////////////////////////////////////////////////////////
+    /// Insert a box and return the handle used to refer to it
+    ////////////////////////////////////////////////////////////
+    Handle add(const BroadphaseBox& box);
+
+    ////////////////////////////////////////////////////////////
+    /// Remove a box; its handle may be reused by a later add()
+    ////////////////////////////////////////////////////////////
+    void remove(Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    /// Move an existing box
+    ////////////////////////////////////////////////////////////
+    void update(Handle handle, const BroadphaseBox& box);
+
+    ////////////////////////////////////////////////////////////
+    /// Re-sort and sweep, returning every overlapping pair
+    ///
+    /// Each pair is reported once with the smaller handle first.
+    /// The returned reference stays valid until the next call.
+    ////////////////////////////////////////////////////////////
+    const std::vector<Pair>& findPairs();
+
+    ////////////////////////////////////////////////////////////
+    /// Number of live boxes
+    ////////////////////////////////////////////////////////////
+    std::size_t size() const;
+
+    ////////////////////////////////////////////////////////////
+    /// Remove every box and release all handles
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+    struct Entry
+    {
+        BroadphaseBox box;
+        Handle        handle;
+    };
+
+    void compact();
+    void sortEntries();
+
+    std::vector<Entry>         m_entries;      ///< Boxes, sorted by minX after findPairs()
+    std::vector<std::uint32_t> m_slots;        ///< Index into m_entries for each handle
+    std::vector<Handle>        m_freeHandles;  ///< Handles released by remove()
+    std::vector<Pair>          m_pairs;        ///< Output of the last findPairs()
+    std::size_t                m_unsorted = 0; ///< Entries appended since the last sort
+    std::size_t                m_removed  = 0; ///< Dead entries awaiting compaction
+};
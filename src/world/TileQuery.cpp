@@ -0,0 +1,277 @@
+#include "TileQuery.hpp"
+
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TILE_QUERY_AVX2 1
+#endif
+
+namespace
+{
+bool clip(const TileGridView& grid, const TileRect& rect, TileRect& clipped)
+{
+    const int left   = std::max(rect.left, 0);
+    const int top    = std::max(rect.top, 0);
+    const int right  = std::min(rect.left + rect.width, grid.width);
+    const int bottom = std::min(rect.top + rect.height, grid.height);
+
+    if (left >= right || top >= bottom)
+        return false;
+
+    clipped = {left, top, right - left, bottom - top};
+    return true;
+}
+
+TileId* rowStart(const TileGridView& grid, const TileRect& rect, int row)
+{
+    return grid.tiles + static_cast<std::size_t>(rect.top + row) * grid.stride + static_cast<std::size_t>(rect.left);
+}
+
+std::size_t countRowScalar(const TileId* tiles, int length, TileId id)
+{
+    std::size_t result = 0;
+    for (int i = 0; i < length; ++i)
+        result += tiles[i] == id;
+
+    return result;
+}
+
+int findRowScalar(const TileId* tiles, int length, TileId id)
+{
+    for (int i = 0; i < length; ++i)
+    {
+        if (tiles[i] == id)
+            return i;
+    }
+
+    return -1;
+}
+
+std::size_t replaceRowScalar(TileId* tiles, int length, TileId from, TileId to)
+{
+    std::size_t result = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        if (tiles[i] == from)
+        {
+            tiles[i] = to;
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+#ifdef TILE_QUERY_AVX2
+// Compiled for AVX2 whatever the global flags, and only called after the
+// CPU check in kernels(), so the binary still runs on older CPUs
+#define TILE_QUERY_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+
+TILE_QUERY_TARGET_AVX2 std::size_t countRowAvx2(const TileId* tiles, int length, TileId id)
+{
+    std::size_t result = 0;
+    int         i      = 0;
+
+    const __m256i needle = _mm256_set1_epi16(static_cast<short>(id));
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tiles + i));
+        const auto    mask   = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(values, needle)));
+
+        // Each matching 16-bit lane sets two mask bits
+        result += static_cast<std::size_t>(__builtin_popcount(mask)) / 2;
+    }
+
+    return result + countRowScalar(tiles + i, length - i, id);
+}
+
+TILE_QUERY_TARGET_AVX2 int findRowAvx2(const TileId* tiles, int length, TileId id)
+{
+    int i = 0;
+
+    const __m256i needle = _mm256_set1_epi16(static_cast<short>(id));
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tiles + i));
+        const auto    mask   = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(values, needle)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask) / 2;
+    }
+
+    const int rest = findRowScalar(tiles + i, length - i, id);
+    return rest < 0 ? -1 : i + rest;
+}
+
+TILE_QUERY_TARGET_AVX2 std::size_t replaceRowAvx2(TileId* tiles, int length, TileId from, TileId to)
+{
+    std::size_t result = 0;
+    int         i      = 0;
+
+    const __m256i needle      = _mm256_set1_epi16(static_cast<short>(from));
+    const __m256i replacement = _mm256_set1_epi16(static_cast<short>(to));
+    for (; i + 16 <= length; i += 16)
+    {
+        auto* const   address = reinterpret_cast<__m256i*>(tiles + i);
+        const __m256i values  = _mm256_loadu_si256(address);
+        const __m256i matches = _mm256_cmpeq_epi16(values, needle);
+        const auto    mask    = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+
+        // Skip the store for untouched blocks so unchanged rows stay clean in cache
+        if (mask == 0)
+            continue;
+
+        _mm256_storeu_si256(address, _mm256_blendv_epi8(values, replacement, matches));
+        result += static_cast<std::size_t>(__builtin_popcount(mask)) / 2;
+    }
+
+    return result + replaceRowScalar(tiles + i, length - i, from, to);
+}
+#endif
+
+struct RowKernels
+{
+    std::size_t (*count)(const TileId*, int, TileId);
+    int (*find)(const TileId*, int, TileId);
+    std::size_t (*replace)(TileId*, int, TileId, TileId);
+};
+
+constexpr RowKernels scalarKernels{countRowScalar, findRowScalar, replaceRowScalar};
+
+bool forcedScalar = false;
+
+// Picked once, on first use
+const RowKernels& detectedKernels()
+{
+    static const RowKernels selected = []
+    {
+#ifdef TILE_QUERY_AVX2
+        if (__builtin_cpu_supports("avx2"))
+            return RowKernels{countRowAvx2, findRowAvx2, replaceRowAvx2};
+#endif
+        return scalarKernels;
+    }();
+
+    return selected;
+}
+
+const RowKernels& kernels()
+{
+    return forcedScalar ? scalarKernels : detectedKernels();
+}
+} // namespace
+
+namespace TileQuery
+{
+bool usesAvx2()
+{
+    return kernels().count != countRowScalar;
+}
+
+void forceScalar(bool scalar)
+{
+    forcedScalar = scalar;
+}
+
+std::size_t count(const TileGridView& grid, const TileRect& rect, TileId id)
+{
+    TileRect area;
+    if (!clip(grid, rect, area))
+        return 0;
+
+    const auto  countRow = kernels().count;
+    std::size_t result   = 0;
+    for (int row = 0; row < area.height; ++row)
+        result += countRow(rowStart(grid, area, row), area.width, id);
+
+    return result;
+}
+
+bool findFirst(const TileGridView& grid, const TileRect& rect, TileId id, int& x, int& y)
+{
+    TileRect area;
+    if (!clip(grid, rect, area))
+        return false;
+
+    const auto findRow = kernels().find;
+    for (int row = 0; row < area.height; ++row)
+    {
+        const int column = findRow(rowStart(grid, area, row), area.width, id);
+        if (column >= 0)
+        {
+            x = area.left + column;
+            y = area.top + row;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::size_t replace(const TileGridView& grid, const TileRect& rect, TileId from, TileId to)
+{
+    TileRect area;
+    if (from == to || !clip(grid, rect, area))
+        return 0;
+
+    const auto  replaceRow = kernels().replace;
+    std::size_t result     = 0;
+    for (int row = 0; row < area.height; ++row)
+        result += replaceRow(rowStart(grid, area, row), area.width, from, to);
+
+    return result;
+}
+
+void histogram(const TileGridView& grid, const TileRect& rect, std::uint32_t* counts, std::size_t idCount)
+{
+    TileRect area;
+    if (!clip(grid, rect, area))
+        return;
+
+    // Scatter increments do not vectorise, and a single table stalls on long
+    // runs of the same id (the common case underground) because each increment
+    // waits for the previous store. Four interleaved tables break that chain.
+    constexpr std::size_t maxSplitIds = 1024;
+    if (idCount > maxSplitIds)
+    {
+        for (int row = 0; row < area.height; ++row)
+        {
+            const TileId* tiles = rowStart(grid, area, row);
+            for (int i = 0; i < area.width; ++i)
+            {
+                if (tiles[i] < idCount)
+                    ++counts[tiles[i]];
+            }
+        }
+        return;
+    }
+
+    // Each table has one extra slot that absorbs out-of-range ids, so the
+    // inner loop has no branch
+    std::uint32_t partial[4][maxSplitIds + 1];
+    for (auto& table : partial)
+        std::fill(table, table + idCount + 1, 0u);
+
+    const auto slot = [idCount](TileId id) { return id < idCount ? id : idCount; };
+
+    for (int row = 0; row < area.height; ++row)
+    {
+        const TileId* tiles = rowStart(grid, area, row);
+
+        int i = 0;
+        for (; i + 4 <= area.width; i += 4)
+        {
+            ++partial[0][slot(tiles[i])];
+            ++partial[1][slot(tiles[i + 1])];
+            ++partial[2][slot(tiles[i + 2])];
+            ++partial[3][slot(tiles[i + 3])];
+        }
+
+        for (; i < area.width; ++i)
+            ++partial[0][slot(tiles[i])];
+    }
+
+    for (std::size_t id = 0; id < idCount; ++id)
+        counts[id] += partial[0][id] + partial[1][id] + partial[2][id] + partial[3][id];
+}
+} // namespace TileQuery
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+using TileId = std::uint16_t;
+
+////////////////////////////////////////////////////////////
+/// Row-major view over a grid of tile ids
+////////////////////////////////////////////////////////////
+struct TileGridView
+{
+    TileId*     tiles  = nullptr;
+    int         width  = 0;
+    int         height = 0;
+    std::size_t stride = 0; ///< Tiles between the starts of two rows, usually width
+};
+
+////////////////////////////////////////////////////////////
+/// Rectangle in tile coordinates; clipped to the grid by queries
+////////////////////////////////////////////////////////////
+struct TileRect
+{
+    int left   = 0;
+    int top    = 0;
+    int width  = 0;
+    int height = 0;
+};
+
+////////////////////////////////////////////////////////////
+/// Bulk tile queries and edits
+///
+/// Each row of the rectangle is processed 16 tiles at a time
+/// with AVX2 compares and masks when the CPU supports AVX2,
+/// checked once at runtime, and by plain loops otherwise. No
+/// global -mavx2 is needed. Both paths give identical results.
+////////////////////////////////////////////////////////////
+namespace TileQuery
+{
+////////////////////////////////////////////////////////////
+/// Whether queries currently run the AVX2 row kernels
+////////////////////////////////////////////////////////////
+bool usesAvx2();
+
+////////////////////////////////////////////////////////////
+/// Run the scalar kernels even on AVX2 CPUs
+///
+/// For tests and benchmarks comparing the two paths. Not
+/// thread-safe: do not call while other threads query.
+////////////////////////////////////////////////////////////
+void forceScalar(bool scalar);
+
+////////////////////////////////////////////////////////////
+/// Number of tiles equal to \a id in \a rect
+////////////////////////////////////////////////////////////
+std::size_t count(const TileGridView& grid, const TileRect& rect, TileId id);
+
+////////////////////////////////////////////////////////////
+/// First tile equal to \a id, scanning rows top to bottom
+///
+/// For "first air below (x, y)", pass a one-wide rect.
+///
+/// \return False if there is none; \a x and \a y are untouched
+////////////////////////////////////////////////////////////
+bool findFirst(const TileGridView& grid, const TileRect& rect, TileId id, int& x, int& y);
+
+////////////////////////////////////////////////////////////
+/// Replace every \a from tile with \a to
+///
+/// \return Number of tiles replaced
+////////////////////////////////////////////////////////////
+std::size_t replace(const TileGridView& grid, const TileRect& rect, TileId from, TileId to);
+
+////////////////////////////////////////////////////////////
+/// Add the count of each tile id in \a rect to \a counts
+///
+/// \a counts must hold \a idCount entries; ids at or above
+/// \a idCount are ignored.
+////////////////////////////////////////////////////////////
+void histogram(const TileGridView& grid, const TileRect& rect, std::uint32_t* counts, std::size_t idCount);
+} // namespace TileQuery